@@ -1,34 +1,351 @@
-//Shabarov Vladimir 090304-RPIa-024
-
-#include <iostream>
-using namespace std;
-
-int main() {
-    int n;
-    cin >> n; 
-    int i = 2;
-    bool k = false; 
-    
-    if (n % i != 0) {
-        int j = 3;
-        while (j * j < n + 1) {
-            if (n % j == 0) {
-                k = true; 
-                i = j; 
-                break; 
-            }
-            j += 2; 
-        }
-    } else {
-        k = true; 
-    }
-
-    
-    if (k) {
-        cout << (i - 1) * (n / i) << " " << n / i << endl;
-    } else {
-        cout << 1 << " " << n - 1 << endl;
-    }
-
-    return 0;
-}
\ No newline at end of file
+//Shabarov Vladimir 090304-RPIa-024
+
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <system_error>
+using namespace std;
+using namespace std::chrono;
+
+typedef unsigned __int128 uint128_t;
+
+// Арифметика по нечётному модулю в форме Монтгомери (R = 2^64)
+class Montgomery {
+private:
+    uint64_t mod;
+    uint64_t inv;   // mod * inv = 1 (mod 2^64)
+    uint64_t r2;    // R^2 mod mod
+
+public:
+    explicit Montgomery(uint64_t n) : mod(n), inv(n) {
+        // Итерации Ньютона: каждая удваивает число верных битов
+        for (int i = 0; i < 5; ++i) inv *= 2 - n * inv;
+        uint64_t r = (0 - n) % n;
+        r2 = (uint64_t)((uint128_t)r * r % n);
+    }
+
+    uint64_t reduce(uint128_t t) const {
+        uint64_t m = (uint64_t)t * inv;
+        uint64_t hi = (uint64_t)(t >> 64);
+        uint64_t mn = (uint64_t)(((uint128_t)m * mod) >> 64);
+        return hi >= mn ? hi - mn : hi - mn + mod;
+    }
+
+    uint64_t mul(uint64_t a, uint64_t b) const { return reduce((uint128_t)a * b); }
+    uint64_t toMont(uint64_t a) const { return mul(a % mod, r2); }
+    uint64_t fromMont(uint64_t a) const { return reduce(a); }
+
+    uint64_t pow(uint64_t a, uint64_t e) const {
+        uint64_t result = toMont(1);
+        while (e) {
+            if (e & 1) result = mul(result, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return result;
+    }
+};
+
+uint64_t gcd64(uint64_t a, uint64_t b) {
+    while (b) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Детерминированный тест Миллера-Рабина для нечётного n > 2 (базы Джима Синклера
+// дают точный ответ для всех 64-битных чисел)
+bool isPrime(uint64_t n) {
+    static const uint64_t bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    Montgomery mg(n);
+    uint64_t d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        ++s;
+    }
+    const uint64_t one = mg.toMont(1);
+    const uint64_t minusOne = mg.toMont(n - 1);
+    for (uint64_t a : bases) {
+        if (a % n == 0) continue;
+        uint64_t x = mg.pow(mg.toMont(a), d);
+        if (x == one || x == minusOne) continue;
+        bool composite = true;
+        for (int r = 1; r < s && composite; ++r) {
+            x = mg.mul(x, x);
+            if (x == minusOne) composite = false;
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+// Ро-метод Полларда (вариант Брента) для нечётного составного n без малых делителей.
+// Возвращает нетривиальный делитель, не обязательно простой.
+uint64_t pollardRho(uint64_t n) {
+    Montgomery mg(n);
+    const int BATCH = 128;   // разности копятся в произведение, НОД - раз на BATCH шагов
+    for (uint64_t c = 1;; ++c) {
+        const uint64_t cm = mg.toMont(c);
+        auto f = [&](uint64_t x) {
+            uint64_t y = mg.mul(x, x) + cm;
+            return y >= n || y < cm ? y - n : y;
+        };
+        uint64_t x = 0, y = mg.toMont(2), ys = y, q = mg.toMont(1), g = 1;
+        for (uint64_t r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (uint64_t i = 0; i < r; ++i) y = f(y);
+            for (uint64_t k = 0; k < r && g == 1; k += BATCH) {
+                ys = y;
+                for (uint64_t i = 0; i < BATCH && i < r - k; ++i) {
+                    y = f(y);
+                    q = mg.mul(q, x > y ? x - y : y - x);
+                }
+                g = gcd64(q, n);
+            }
+        }
+        // Произведение обнулилось: повторяем последний отрезок по одному шагу
+        if (g == n) {
+            do {
+                ys = f(ys);
+                g = gcd64(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n) return g;
+    }
+}
+
+// Наименьший простой делитель 64-битных чисел.
+// До sieveLimit - таблица наименьших делителей нечётных чисел (0 - простое),
+// дальше - пробное деление на малые простые, Миллер-Рабин и ро-метод Полларда.
+class SmallestFactor {
+private:
+    static constexpr uint32_t TRIAL_LIMIT = 256;
+    uint64_t sieveLimit;
+    vector<uint16_t> oddFactor;     // индекс n / 2 для нечётного n
+    vector<uint32_t> smallPrimes;   // нечётные простые < TRIAL_LIMIT
+
+    uint64_t fromSieve(uint64_t n) const {
+        uint16_t p = oddFactor[n >> 1];
+        return p ? p : n;
+    }
+
+    // n нечётное, без делителей < TRIAL_LIMIT
+    uint64_t largeFactor(uint64_t n) const {
+        if (n < sieveLimit) return fromSieve(n);
+        if (isPrime(n)) return n;
+        uint64_t d = pollardRho(n);
+        return min(largeFactor(d), largeFactor(n / d));
+    }
+
+public:
+    // sieveLimit не больше 2^32: делители составных чисел таблицы помещаются в uint16_t
+    explicit SmallestFactor(uint64_t limit = 1 << 24)
+        : sieveLimit(max<uint64_t>(limit, TRIAL_LIMIT * TRIAL_LIMIT)), oddFactor(sieveLimit / 2 + 1, 0) {
+        for (uint64_t p = 3; p * p < sieveLimit; p += 2) {
+            if (oddFactor[p >> 1]) continue;
+            for (uint64_t q = p * p; q < sieveLimit; q += 2 * p) {
+                if (!oddFactor[q >> 1]) oddFactor[q >> 1] = (uint16_t)p;
+            }
+        }
+        for (uint32_t p = 3; p < TRIAL_LIMIT; p += 2) {
+            if (!oddFactor[p >> 1]) smallPrimes.push_back(p);
+        }
+    }
+
+    // Для n < 2 возвращает n (как и для простых: делителя меньше самого числа нет)
+    uint64_t operator()(uint64_t n) const {
+        if ((n & 1) == 0) return n ? 2 : 0;
+        if (n < sieveLimit) return fromSieve(n);
+        for (uint32_t p : smallPrimes) {
+            if (n % p == 0) return p;
+        }
+        return largeFactor(n);
+    }
+};
+
+// Ответ для n по наименьшему простому делителю i:
+// "(i - 1) * (n / i) n / i", а для простого n (и n = 1) - "1 n - 1"
+void appendAnswer(string& out, uint64_t n, const SmallestFactor& smallestFactor) {
+    uint64_t i = (n & 1) ? smallestFactor(n) : 2;
+    uint64_t first = 1, second = n - 1;
+    if (i != n && n != 1) {
+        first = (i - 1) * (n / i);
+        second = n / i;
+    }
+    char buffer[48];
+    char* end = buffer + sizeof(buffer) - 1;
+    char* p = to_chars(buffer, end, first).ptr;
+    *p++ = ' ';
+    p = to_chars(p, end, second).ptr;
+    *p++ = '\n';
+    out.append(buffer, p);
+}
+
+// Разбор одного числа: только цифры, значение должно помещаться в uint64_t.
+// Отрицательные числа и переполнение - ошибка с сообщением в error.
+bool parseNumber(const char* begin, const char* end, uint64_t& n, string& error) {
+    if (begin != end && *begin == '-') {
+        error = "отрицательные числа не поддерживаются";
+        return false;
+    }
+    auto [ptr, ec] = from_chars(begin, end, n);
+    if (ec == errc::result_out_of_range) {
+        error = "число больше 2^64 - 1";
+        return false;
+    }
+    if (ec != errc() || ptr != end) {
+        error = "не число";
+        return false;
+    }
+    return true;
+}
+
+// Пакетный режим: числа из потока, разделённые пробельными символами,
+// по строке ответа на каждое. Поток читается блоками до BATCH_BLOCK байт
+// (сколько уже доступно, не дожидаясь конца ввода), ответы на блок выводятся
+// сразу после него, так что память не растёт с объёмом ввода и ответы идут
+// по мере поступления чисел из канала. Число, разрезанное границей блока,
+// дособирается в partial. Некорректные числа пропускаются с сообщением в cerr;
+// возвращается их количество.
+const streamsize BATCH_BLOCK = 1 << 16;
+// Длиннее числа в uint64_t быть не может (с запасом на ведущие нули)
+const size_t MAX_TOKEN = 64;
+
+size_t runBatch(istream& in, const SmallestFactor& smallestFactor) {
+    streambuf* source = in.rdbuf();
+    vector<char> block(BATCH_BLOCK);
+    string out, error, partial;
+    out.reserve(1 << 20);
+    size_t index = 0, rejected = 0;
+
+    auto answer = [&](const char* begin, const char* end) {
+        ++index;
+        uint64_t n = 0;
+        if (end - begin > (ptrdiff_t)MAX_TOKEN) {
+            cerr << "Пропущено число " << index << " \"" << string(begin, MAX_TOKEN) << "...\": слишком длинное" << endl;
+            ++rejected;
+        } else if (!parseNumber(begin, end, n, error)) {
+            cerr << "Пропущено число " << index << " \"" << string(begin, end) << "\": " << error << endl;
+            ++rejected;
+        } else {
+            appendAnswer(out, n, smallestFactor);
+        }
+    };
+
+    // Хвост числа на границе блока; сверх MAX_TOKEN + 1 символов не копится
+    auto keep = [&](const char* begin, const char* end) {
+        size_t room = partial.size() <= MAX_TOKEN ? MAX_TOKEN + 1 - partial.size() : 0;
+        partial.append(begin, min<size_t>(end - begin, room));
+    };
+
+    while (true) {
+        // Без буферизованных данных читается один байт: read() канала
+        // вернёт всё, что уже пришло, и следующий блок заберёт остальное
+        streamsize available = source->in_avail();
+        streamsize got = source->sgetn(block.data(), available > 0 ? min(available, BATCH_BLOCK) : 1);
+        if (got <= 0) break;
+
+        const char* p = block.data();
+        const char* end = p + got;
+        while (p < end) {
+            const char* token = p;
+            while (p < end && !isspace((unsigned char)*p)) ++p;
+            if (p == end) {
+                // Число может продолжиться в следующем блоке
+                keep(token, p);
+                break;
+            }
+            if (!partial.empty()) {
+                keep(token, p);
+                answer(partial.data(), partial.data() + partial.size());
+                partial.clear();
+            } else if (token != p) {
+                answer(token, p);
+            }
+            while (p < end && isspace((unsigned char)*p)) ++p;
+        }
+
+        cout.write(out.data(), out.size());
+        cout.flush();
+        out.clear();
+    }
+    if (!partial.empty()) answer(partial.data(), partial.data() + partial.size());
+    cout.write(out.data(), out.size());
+    cout.flush();
+    return rejected;
+}
+
+// Пропускная способность (чисел/с) для случайных чисел разной разрядности
+void runBenchmark(const SmallestFactor& smallestFactor, int count) {
+    mt19937_64 rng(42);
+    cout << "Бит\tЧисел/с\t\tмкс/число" << endl;
+    for (int bits = 16; bits <= 64; bits += 8) {
+        vector<uint64_t> values(count);
+        for (auto& v : values) {
+            v = rng();
+            if (bits < 64) v &= (1ULL << bits) - 1;
+            v |= 1ULL << (bits - 1);
+        }
+        uint64_t checksum = 0;
+        auto start = high_resolution_clock::now();
+        for (uint64_t v : values) checksum += smallestFactor(v);
+        double seconds = duration<double>(high_resolution_clock::now() - start).count();
+        cout << bits << "\t" << (uint64_t)(count / seconds) << "\t\t"
+             << seconds * 1e6 / count << "\t(контроль " << checksum % 1000 << ")" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+
+    // --batch [файл]: много чисел из файла или стандартного ввода
+    if (mode == "--batch") {
+        // Без синхронизации с stdio cin буферизован и in_avail() видит прочитанное
+        ios::sync_with_stdio(false);
+        SmallestFactor smallestFactor;
+        size_t rejected;
+        if (argc > 2) {
+            ifstream file(argv[2], ios::binary);
+            if (!file) {
+                cerr << "Ошибка открытия файла" << endl;
+                return 1;
+            }
+            rejected = runBatch(file, smallestFactor);
+        } else {
+            rejected = runBatch(cin, smallestFactor);
+        }
+        return rejected ? 1 : 0;
+    }
+
+    // --bench [количество]: скорость по разрядности входа
+    if (mode == "--bench") {
+        SmallestFactor smallestFactor;
+        runBenchmark(smallestFactor, argc > 2 ? max(1, atoi(argv[2])) : 100000);
+        return 0;
+    }
+
+    string token, error;
+    cin >> token;
+    uint64_t n;
+    if (!parseNumber(token.data(), token.data() + token.size(), n, error)) {
+        cerr << "Некорректное число \"" << token << "\": " << error << endl;
+        return 1;
+    }
+    SmallestFactor smallestFactor(1 << 16);
+    string out;
+    appendAnswer(out, n, smallestFactor);
+    cout << out;
+
+    return 0;
+}
@@ -5,26 +5,37 @@
 #include <chrono>
 #include <cstdlib>
 #include <algorithm>
+#include <vector>
+#include <string>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <new>
+#include <iomanip>
+#include <cstring>
 #include <cblas.h>
+#include "thread_pool.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 using namespace std::chrono;
 
 const int SIZE = 2048;
-const int BLOCK_SIZE = 64;
 using Complex = complex<double>;
 
-void generate_matrices(Complex* A, Complex* B) {
+void generate_matrices(Complex* A, Complex* B, int n) {
     srand(42);
-    for (int i = 0; i < SIZE * SIZE; ++i) {
+    for (size_t i = 0; i < (size_t)n * n; ++i) {
         A[i] = Complex((rand() % 100) - 50.0, (rand() % 100) - 50.0);
         B[i] = Complex((rand() % 100) - 50.0, (rand() % 100) - 50.0);
     }
 }
 
 // Проверка матриц на равенство 
-bool are_matrices_equal(const Complex* A, const Complex* B, double epsilon = 1e-6) {
-    for (int i = 0; i < SIZE * SIZE; ++i) {
+bool are_matrices_equal(const Complex* A, const Complex* B, int n, double epsilon = 1e-6) {
+    for (size_t i = 0; i < (size_t)n * n; ++i) {
         if (abs(A[i].real() - B[i].real()) > epsilon || 
             abs(A[i].imag() - B[i].imag()) > epsilon) {
             return false;
@@ -34,80 +45,451 @@ bool are_matrices_equal(const Complex* A, const Complex* B, double epsilon = 1e-
 }
 
 // Простое матричное умножение
-void simple_matrix_multiply(const Complex* A, const Complex* B, Complex* C) {
-    for (int i = 0; i < SIZE; ++i) {
-        for (int k = 0; k < SIZE; ++k) {
-            Complex temp = A[i * SIZE + k];
-            for (int j = 0; j < SIZE; ++j) {
-                C[i * SIZE + j] += temp * B[k * SIZE + j];
+void simple_matrix_multiply(const Complex* A, const Complex* B, Complex* C, int n) {
+    for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < n; ++k) {
+            Complex temp = A[(size_t)i * n + k];
+            for (int j = 0; j < n; ++j) {
+                C[(size_t)i * n + j] += temp * B[(size_t)k * n + j];
             }
         }
     }
 }
 
 // Умножение с использованием OpenBLAS
-void openblas_matrix_multiply(const Complex* A, const Complex* B, Complex* C) {
+void openblas_matrix_multiply(const Complex* A, const Complex* B, Complex* C, int n) {
     const Complex one(1.0, 0.0);
     const Complex zero(0.0, 0.0);
     cblas_zgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
-                SIZE, SIZE, SIZE,
+                n, n, n,
                 &one,
-                A, SIZE,
-                B, SIZE,
+                A, n,
+                B, n,
                 &zero,
-                C, SIZE);
-}
-
-void transpose_matrix(const Complex* A, Complex* AT) {
-    for (int i = 0; i < SIZE; ++i) {
-        for (int j = 0; j < SIZE; ++j) {
-            AT[j * SIZE + i] = A[i * SIZE + j];
-        }
-    }
-}
-
-// Блочное умножение с транспонированием 
-void blocked_transposed_multiply(const Complex* A, const Complex* B, Complex* C, int blockSize) {
-    Complex* BT = new Complex[SIZE * SIZE];
-    transpose_matrix(B, BT);
-    
-    for (int ii = 0; ii < SIZE; ii += blockSize) {
-        for (int jj = 0; jj < SIZE; jj += blockSize) {
-            for (int kk = 0; kk < SIZE; kk += blockSize) {
-                const int i_end = min(ii + blockSize, SIZE);
-                const int j_end = min(jj + blockSize, SIZE);
-                const int k_end = min(kk + blockSize, SIZE);
-                
-                for (int i = ii; i < i_end; ++i) {
-                    for (int j = jj; j < j_end; ++j) {
-                        Complex sum(0.0, 0.0);
-                        for (int k = kk; k < k_end; ++k) {
-                            sum += A[i * SIZE + k] * BT[j * SIZE + k];
+                C, n);
+}
+
+// Упакованное умножение с SIMD-микроядром.
+// Блоки A и B копируются в непрерывные панели, где действительные и мнимые
+// части лежат в отдельных плоскостях, а микроядро считает плитку MR x NR
+// матрицы C в регистрах. Набор инструкций выбирается при запуске.
+
+// Размеры блоков по k, i и j (панель B размером KC x NC держится в L2/L3)
+const int KC_BLOCK = 256;
+const int MC_BLOCK = 96;
+const int NC_BLOCK = 2048;
+const int MAX_MR = 4;
+const int MAX_NR = 16;
+
+// Микроядро: cre/cim (MR x NR) = сумма по p упакованных A и B
+using MicroKernelFn = void (*)(int kc, const double* ar, const double* ai,
+                               const double* br, const double* bi,
+                               double* cre, double* cim);
+
+struct MicroKernel {
+    int mr;
+    int nr;
+    MicroKernelFn fn;
+    const char* name;
+};
+
+void microkernel_scalar(int kc, const double* ar, const double* ai,
+                        const double* br, const double* bi,
+                        double* cre, double* cim) {
+    const int MR = 4, NR = 4;
+    double re[MR][NR] = {}, im[MR][NR] = {};
+    for (int p = 0; p < kc; ++p) {
+        for (int r = 0; r < MR; ++r) {
+            double a_re = ar[p * MR + r], a_im = ai[p * MR + r];
+            for (int c = 0; c < NR; ++c) {
+                re[r][c] += a_re * br[p * NR + c] - a_im * bi[p * NR + c];
+                im[r][c] += a_re * bi[p * NR + c] + a_im * br[p * NR + c];
+            }
+        }
+    }
+    for (int r = 0; r < MR; ++r) {
+        for (int c = 0; c < NR; ++c) {
+            cre[r * NR + c] = re[r][c];
+            cim[r * NR + c] = im[r][c];
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// AVX2 + FMA: плитка 2 x 8, 8 аккумуляторов по 4 double
+__attribute__((target("avx2,fma")))
+void microkernel_avx2(int kc, const double* ar, const double* ai,
+                      const double* br, const double* bi,
+                      double* cre, double* cim) {
+    const int MR = 2, NR = 8;
+    __m256d re[MR][2], im[MR][2];
+    for (int r = 0; r < MR; ++r) {
+        re[r][0] = re[r][1] = im[r][0] = im[r][1] = _mm256_setzero_pd();
+    }
+    for (int p = 0; p < kc; ++p) {
+        __m256d br0 = _mm256_loadu_pd(br + p * NR);
+        __m256d br1 = _mm256_loadu_pd(br + p * NR + 4);
+        __m256d bi0 = _mm256_loadu_pd(bi + p * NR);
+        __m256d bi1 = _mm256_loadu_pd(bi + p * NR + 4);
+        for (int r = 0; r < MR; ++r) {
+            __m256d a = _mm256_broadcast_sd(ar + p * MR + r);
+            re[r][0] = _mm256_fmadd_pd(a, br0, re[r][0]);
+            re[r][1] = _mm256_fmadd_pd(a, br1, re[r][1]);
+            im[r][0] = _mm256_fmadd_pd(a, bi0, im[r][0]);
+            im[r][1] = _mm256_fmadd_pd(a, bi1, im[r][1]);
+            a = _mm256_broadcast_sd(ai + p * MR + r);
+            re[r][0] = _mm256_fnmadd_pd(a, bi0, re[r][0]);
+            re[r][1] = _mm256_fnmadd_pd(a, bi1, re[r][1]);
+            im[r][0] = _mm256_fmadd_pd(a, br0, im[r][0]);
+            im[r][1] = _mm256_fmadd_pd(a, br1, im[r][1]);
+        }
+    }
+    for (int r = 0; r < MR; ++r) {
+        _mm256_storeu_pd(cre + r * NR, re[r][0]);
+        _mm256_storeu_pd(cre + r * NR + 4, re[r][1]);
+        _mm256_storeu_pd(cim + r * NR, im[r][0]);
+        _mm256_storeu_pd(cim + r * NR + 4, im[r][1]);
+    }
+}
+
+// AVX-512F: плитка 4 x 16, 16 аккумуляторов по 8 double
+__attribute__((target("avx512f")))
+void microkernel_avx512(int kc, const double* ar, const double* ai,
+                        const double* br, const double* bi,
+                        double* cre, double* cim) {
+    const int MR = 4, NR = 16;
+    __m512d re[MR][2], im[MR][2];
+    for (int r = 0; r < MR; ++r) {
+        re[r][0] = re[r][1] = im[r][0] = im[r][1] = _mm512_setzero_pd();
+    }
+    for (int p = 0; p < kc; ++p) {
+        __m512d br0 = _mm512_loadu_pd(br + p * NR);
+        __m512d br1 = _mm512_loadu_pd(br + p * NR + 8);
+        __m512d bi0 = _mm512_loadu_pd(bi + p * NR);
+        __m512d bi1 = _mm512_loadu_pd(bi + p * NR + 8);
+        for (int r = 0; r < MR; ++r) {
+            __m512d a = _mm512_set1_pd(ar[p * MR + r]);
+            re[r][0] = _mm512_fmadd_pd(a, br0, re[r][0]);
+            re[r][1] = _mm512_fmadd_pd(a, br1, re[r][1]);
+            im[r][0] = _mm512_fmadd_pd(a, bi0, im[r][0]);
+            im[r][1] = _mm512_fmadd_pd(a, bi1, im[r][1]);
+            a = _mm512_set1_pd(ai[p * MR + r]);
+            re[r][0] = _mm512_fnmadd_pd(a, bi0, re[r][0]);
+            re[r][1] = _mm512_fnmadd_pd(a, bi1, re[r][1]);
+            im[r][0] = _mm512_fmadd_pd(a, br0, im[r][0]);
+            im[r][1] = _mm512_fmadd_pd(a, br1, im[r][1]);
+        }
+    }
+    for (int r = 0; r < MR; ++r) {
+        _mm512_storeu_pd(cre + r * NR, re[r][0]);
+        _mm512_storeu_pd(cre + r * NR + 8, re[r][1]);
+        _mm512_storeu_pd(cim + r * NR, im[r][0]);
+        _mm512_storeu_pd(cim + r * NR + 8, im[r][1]);
+    }
+}
+#endif
+
+// Выбор микроядра по возможностям процессора (один раз за запуск)
+const MicroKernel& select_microkernel() {
+    static const MicroKernel kernel = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return MicroKernel{4, 16, microkernel_avx512, "AVX-512"};
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return MicroKernel{2, 8, microkernel_avx2, "AVX2+FMA"};
+        }
+#endif
+        return MicroKernel{4, 4, microkernel_scalar, "scalar"};
+    }();
+    return kernel;
+}
+
+// Упаковка блока A (mc x kc) в полосы по MR строк, хвост дополняется нулями
+void pack_a(const Complex* A, int lda, int mc, int kc, int MR, double* ar, double* ai) {
+    for (int i = 0; i < mc; i += MR) {
+        const int rows = min(MR, mc - i);
+        for (int p = 0; p < kc; ++p) {
+            for (int r = 0; r < MR; ++r) {
+                Complex v = r < rows ? A[(i + r) * lda + p] : Complex(0.0, 0.0);
+                ar[p * MR + r] = v.real();
+                ai[p * MR + r] = v.imag();
+            }
+        }
+        ar += MR * kc;
+        ai += MR * kc;
+    }
+}
+
+// Упаковка блока B (kc x nc) в полосы по NR столбцов, хвост дополняется нулями
+void pack_b(const Complex* B, int ldb, int kc, int nc, int NR, double* br, double* bi) {
+    for (int j = 0; j < nc; j += NR) {
+        const int cols = min(NR, nc - j);
+        for (int p = 0; p < kc; ++p) {
+            for (int c = 0; c < NR; ++c) {
+                Complex v = c < cols ? B[p * ldb + j + c] : Complex(0.0, 0.0);
+                br[p * NR + c] = v.real();
+                bi[p * NR + c] = v.imag();
+            }
+        }
+        br += NR * kc;
+        bi += NR * kc;
+    }
+}
+
+// C (m x n) += A (m x k) * B (k x n), матрицы построчные с ведущими размерностями
+void packed_matrix_multiply(int m, int n, int k,
+                            const Complex* A, int lda,
+                            const Complex* B, int ldb,
+                            Complex* C, int ldc) {
+    const MicroKernel& kernel = select_microkernel();
+    const int MR = kernel.mr, NR = kernel.nr;
+    const int mc_max = (MC_BLOCK + MR - 1) / MR * MR;
+    const int nc_max = (NC_BLOCK + NR - 1) / NR * NR;
+
+    // Буферы упаковки переиспользуются между вызовами в пределах потока
+    thread_local vector<double> a_buf, b_buf;
+    a_buf.resize(2 * (size_t)mc_max * KC_BLOCK);
+    b_buf.resize(2 * (size_t)nc_max * KC_BLOCK);
+    double* ar = a_buf.data();
+    double* ai = ar + (size_t)mc_max * KC_BLOCK;
+    double* br = b_buf.data();
+    double* bi = br + (size_t)nc_max * KC_BLOCK;
+
+    double cre[MAX_MR * MAX_NR], cim[MAX_MR * MAX_NR];
+
+    for (int jc = 0; jc < n; jc += NC_BLOCK) {
+        const int nc = min(NC_BLOCK, n - jc);
+        for (int pc = 0; pc < k; pc += KC_BLOCK) {
+            const int kc = min(KC_BLOCK, k - pc);
+            pack_b(B + (size_t)pc * ldb + jc, ldb, kc, nc, NR, br, bi);
+
+            for (int ic = 0; ic < m; ic += MC_BLOCK) {
+                const int mc = min(MC_BLOCK, m - ic);
+                pack_a(A + (size_t)ic * lda + pc, lda, mc, kc, MR, ar, ai);
+
+                for (int jr = 0; jr < nc; jr += NR) {
+                    const int cols = min(NR, nc - jr);
+                    const double* br_panel = br + (size_t)jr * kc;
+                    const double* bi_panel = bi + (size_t)jr * kc;
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        const int rows = min(MR, mc - ir);
+                        kernel.fn(kc, ar + (size_t)ir * kc, ai + (size_t)ir * kc,
+                                  br_panel, bi_panel, cre, cim);
+
+                        Complex* c_tile = C + (size_t)(ic + ir) * ldc + jc + jr;
+                        for (int r = 0; r < rows; ++r) {
+                            for (int c = 0; c < cols; ++c) {
+                                c_tile[r * ldc + c] += Complex(cre[r * NR + c], cim[r * NR + c]);
+                            }
                         }
-                        C[i * SIZE + j] += sum;
                     }
                 }
             }
         }
     }
-    
-    delete[] BT;
 }
 
-int main() {
-    Complex* A = new Complex[SIZE * SIZE];
-    Complex* B = new Complex[SIZE * SIZE];
-    Complex* C_simple = new Complex[SIZE * SIZE];
-    Complex* C_openblas = new Complex[SIZE * SIZE];
-    Complex* C_blocked = new Complex[SIZE * SIZE];
+// Наибольшие плитки матрицы C для параллельного умножения
+const int TILE_ROWS = 192;
+const int TILE_COLS = 512;
+// Сколько плиток должно приходиться на поток, чтобы было что перераспределять
+const int TILES_PER_THREAD = 4;
 
-    generate_matrices(A, B);
-    const double flops = 8.0 * SIZE * SIZE * SIZE;
+// Разбиение плиток между потоками: поток t владеет непрерывным диапазоном
+// [first_tile(t), first_tile(t + 1)) в построчном порядке обхода плиток.
+// Одно и то же разбиение используется при первом касании памяти и при счёте,
+// поэтому на NUMA-машинах страницы C оказываются на узле своего потока.
+// Плитки уменьшаются, пока их меньше TILES_PER_THREAD на поток: строки - кратно
+// MC_BLOCK (не меньше одного блока), затем столбцы - кратно NR микроядра.
+struct TileGrid {
+    int n, rows, cols, tiles_i, tiles_j, threads;
+
+    TileGrid(int n, int threads) : n(n), rows(TILE_ROWS), cols(TILE_COLS), threads(threads) {
+        const int nr = select_microkernel().nr;
+        const long long wanted = (long long)TILES_PER_THREAD * threads;
+        while (threads > 1 && tiles(rows) * tiles(cols) < wanted) {
+            if (rows > MC_BLOCK) rows -= MC_BLOCK;
+            else if (cols > nr) cols = max(nr, cols / 2 / nr * nr);
+            else break;
+        }
+        tiles_i = tiles(rows);
+        tiles_j = tiles(cols);
+    }
+
+    long long tiles(int size) const { return (n + size - 1) / size; }
+    int count() const { return tiles_i * tiles_j; }
+    // Строка и столбец начала плитки t и её размеры
+    int row(int t) const { return t / tiles_j * rows; }
+    int col(int t) const { return t % tiles_j * cols; }
+    int height(int t) const { return min(rows, n - row(t)); }
+    int width(int t) const { return min(cols, n - col(t)); }
+    int first_tile(int t) const { return (int)((long long)count() * t / threads); }
+};
+
+// Выделение матрицы n x n без инициализации и обнуление её плиток
+// теми же потоками, которые потом будут их считать (first touch)
+Complex* allocate_matrix(ThreadPool& pool, int n) {
+    Complex* M = static_cast<Complex*>(::operator new[](sizeof(Complex) * (size_t)n * n, align_val_t(64)));
+    TileGrid grid(n, pool.size());
+    pool.run([&](int tid) {
+        for (int t = grid.first_tile(tid); t < grid.first_tile(tid + 1); ++t) {
+            const int i0 = grid.row(t), j0 = grid.col(t);
+            const int rows = grid.height(t), cols = grid.width(t);
+            for (int i = i0; i < i0 + rows; ++i) {
+                memset(static_cast<void*>(M + (size_t)i * n + j0), 0, sizeof(Complex) * cols);
+            }
+        }
+    });
+    return M;
+}
+
+void free_matrix(Complex* M) {
+    ::operator delete[](M, align_val_t(64));
+}
+
+// Параллельное умножение C += A * B: каждый поток сначала считает свои плитки,
+// затем забирает оставшиеся плитки у других потоков (work stealing)
+void parallel_matrix_multiply(ThreadPool& pool, const Complex* A, const Complex* B, Complex* C, int n) {
+    TileGrid grid(n, pool.size());
+    vector<atomic<int>> next(grid.threads);
+    for (int t = 0; t < grid.threads; ++t) next[t] = grid.first_tile(t);
+
+    pool.run([&](int tid) {
+        for (int v = 0; v < grid.threads; ++v) {
+            const int owner = (tid + v) % grid.threads;
+            const int last = grid.first_tile(owner + 1);
+            for (int t = next[owner]++; t < last; t = next[owner]++) {
+                const int i0 = grid.row(t), j0 = grid.col(t);
+                const int rows = grid.height(t), cols = grid.width(t);
+                packed_matrix_multiply(rows, cols, n, A + (size_t)i0 * n, n,
+                                       B + j0, n, C + (size_t)i0 * n + j0, n);
+            }
+        }
+    });
+}
+
+// Медиана времени выполнения fn за reps повторов после одного прогрева
+double median_time(int reps, const function<void()>& fn) {
+    fn();
+    vector<double> times;
+    for (int r = 0; r < reps; ++r) {
+        auto start = high_resolution_clock::now();
+        fn();
+        auto end = high_resolution_clock::now();
+        times.push_back(duration<double>(end - start).count());
+    }
+    sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+// Режим бенчмарка: перебор размеров и числа потоков, сравнение с OpenBLAS
+// при том же числе потоков
+void run_scaling_benchmark(const vector<int>& sizes, int max_threads, int reps) {
+    vector<int> thread_counts;
+    for (int t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    cout << "Kernel: " << select_microkernel().name << ", repetitions: " << reps << " (median)\n";
+    cout << setw(6) << "size" << setw(9) << "threads"
+         << setw(12) << "custom, s" << setw(12) << "GFlops"
+         << setw(14) << "OpenBLAS, s" << setw(12) << "GFlops"
+         << setw(14) << "vs OpenBLAS" << setw(12) << "scaling" << "\n";
+
+    for (int n : sizes) {
+        const double flops = 8.0 * n * n * n;
+        double single_thread_time = 0;
+        for (int threads : thread_counts) {
+            ThreadPool pool(threads);
+            Complex* A = allocate_matrix(pool, n);
+            Complex* B = allocate_matrix(pool, n);
+            Complex* C = allocate_matrix(pool, n);
+            Complex* C_openblas = allocate_matrix(pool, n);
+            generate_matrices(A, B, n);
+            openblas_set_num_threads(threads);
+
+            // Проверочный прогон: C обнулена, результат сверяется с OpenBLAS.
+            // Время неверного результата в таблицу не выводится.
+            memset(static_cast<void*>(C), 0, sizeof(Complex) * (size_t)n * n);
+            parallel_matrix_multiply(pool, A, B, C, n);
+            openblas_matrix_multiply(A, B, C_openblas, n);
+            const bool correct = are_matrices_equal(C, C_openblas, n);
+
+            if (correct) {
+                // Замеры копят сумму в C (C += A * B), она уже проверена
+                double custom_time = median_time(reps, [&] { parallel_matrix_multiply(pool, A, B, C, n); });
+                double openblas_time = median_time(reps, [&] { openblas_matrix_multiply(A, B, C_openblas, n); });
+                if (threads == 1) single_thread_time = custom_time;
+
+                cout << setw(6) << n << setw(9) << threads
+                     << setw(12) << custom_time << setw(12) << flops / custom_time * 1e-9
+                     << setw(14) << openblas_time << setw(12) << flops / openblas_time * 1e-9
+                     << setw(13) << openblas_time / custom_time << "x"
+                     << setw(11) << single_thread_time / custom_time << "x\n";
+            } else {
+                cout << setw(6) << n << setw(9) << threads
+                     << "  WARNING: parallel and OpenBLAS results differ, timing skipped\n";
+            }
+
+            free_matrix(A);
+            free_matrix(B);
+            free_matrix(C);
+            free_matrix(C_openblas);
+        }
+    }
+}
+
+// Размер матрицы из аргумента: целое от 1 до MAX_SIZE
+// (MAX_SIZE ограничивает int-размерности cblas и индексы плиток;
+// матрица такого размера уже занимает 64 ГБ)
+const int MAX_SIZE = 1 << 16;
+
+bool parse_matrix_size(const char* text, int& n) {
+    char* end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value <= 0 || value > MAX_SIZE) {
+        cerr << "Matrix size must be an integer from 1 to " << MAX_SIZE << ", got \"" << text << "\"\n";
+        return false;
+    }
+    n = (int)value;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const int max_threads = max(1, (int)thread::hardware_concurrency());
+
+    // --bench [размеры...]: перебор размеров и числа потоков
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        vector<int> sizes;
+        for (int a = 2; a < argc; ++a) {
+            int n;
+            if (!parse_matrix_size(argv[a], n)) return 1;
+            sizes.push_back(n);
+        }
+        if (sizes.empty()) sizes = {256, 512, 1024, 2048};
+        run_scaling_benchmark(sizes, max_threads, 5);
+        return 0;
+    }
+
+    // Размер матриц можно задать первым аргументом, по умолчанию SIZE
+    int n = SIZE;
+    if (argc > 1 && !parse_matrix_size(argv[1], n)) return 1;
+    const size_t elements = (size_t)n * n;
+
+    Complex* A = new Complex[elements];
+    Complex* B = new Complex[elements];
+    Complex* C_simple = new Complex[elements];
+    Complex* C_openblas = new Complex[elements];
+    Complex* C_blocked = new Complex[elements];
+
+    generate_matrices(A, B, n);
+    const double flops = 8.0 * n * n * n;
 
     // Тестирование простого алгоритма
-    fill(C_simple, C_simple + SIZE * SIZE, Complex(0.0, 0.0));
+    fill(C_simple, C_simple + elements, Complex(0.0, 0.0));
     auto start = high_resolution_clock::now();
-    simple_matrix_multiply(A, B, C_simple);
+    simple_matrix_multiply(A, B, C_simple, n);
     auto end = high_resolution_clock::now();
     double simple_time = duration<double>(end - start).count();
     cout << "Simple multiplication:\n";
@@ -115,37 +497,57 @@ int main() {
     cout << "  Performance: " << (flops / simple_time) * 1e-9 << " GFlops\n\n";
 
     // Тестирование OpenBLAS
-    fill(C_openblas, C_openblas + SIZE * SIZE, Complex(0.0, 0.0));
+    fill(C_openblas, C_openblas + elements, Complex(0.0, 0.0));
     start = high_resolution_clock::now();
-    openblas_matrix_multiply(A, B, C_openblas);
+    openblas_matrix_multiply(A, B, C_openblas, n);
     end = high_resolution_clock::now();
     double openblas_time = duration<double>(end - start).count();
     cout << "OpenBLAS multiplication:\n";
     cout << "  Time: " << openblas_time << " s\n";
     cout << "  Performance: " << (flops /openblas_time) * 1e-9 << " GFlops\n\n";
 
-    if (are_matrices_equal(C_simple, C_openblas)) {
+    if (are_matrices_equal(C_simple, C_openblas, n)) {
         cout << "Simple and OpenBLAS results match!\n\n";
     } else {
         cout << "WARNING: Simple and OpenBLAS results differ!\n\n";
     }
 
-    // Тестирование блочного алгоритма с транспонированием
-    fill(C_blocked, C_blocked + SIZE * SIZE, Complex(0.0, 0.0));
+    // Тестирование упакованного SIMD-алгоритма
+    fill(C_blocked, C_blocked + elements, Complex(0.0, 0.0));
     start = high_resolution_clock::now();
-    blocked_transposed_multiply(A, B, C_blocked, BLOCK_SIZE);
+    packed_matrix_multiply(n, n, n, A, n, B, n, C_blocked, n);
     end = high_resolution_clock::now();
     double blocked_time = duration<double>(end - start).count();
-    cout << "Blocked transposed multiplication:\n";
+    cout << "Packed SIMD multiplication (" << select_microkernel().name << "):\n";
     cout << "  Time: " << blocked_time << " s\n";
-    cout << "  Performance: " << (flops / blocked_time) * 1e-9 << " GFlops\n\n";
+    cout << "  Performance: " << (flops / blocked_time) * 1e-9 << " GFlops\n";
+    cout << "  Relative to OpenBLAS: " << openblas_time / blocked_time << "x\n\n";
 
-    if (are_matrices_equal(C_blocked, C_openblas)) {
+    if (are_matrices_equal(C_blocked, C_openblas, n)) {
         cout << "Blocked and OpenBLAS results match!\n\n";
     } else {
         cout << "WARNING: Blocked and OpenBLAS results differ!\n\n";
     }
 
+    // Тестирование параллельного алгоритма
+    ThreadPool pool(max_threads);
+    Complex* C_parallel = allocate_matrix(pool, n);
+    start = high_resolution_clock::now();
+    parallel_matrix_multiply(pool, A, B, C_parallel, n);
+    end = high_resolution_clock::now();
+    double parallel_time = duration<double>(end - start).count();
+    cout << "Parallel packed multiplication (" << pool.size() << " threads):\n";
+    cout << "  Time: " << parallel_time << " s\n";
+    cout << "  Performance: " << (flops / parallel_time) * 1e-9 << " GFlops\n";
+    cout << "  Speedup over single thread: " << blocked_time / parallel_time << "x\n\n";
+
+    if (are_matrices_equal(C_parallel, C_openblas, n)) {
+        cout << "Parallel and OpenBLAS results match!\n\n";
+    } else {
+        cout << "WARNING: Parallel and OpenBLAS results differ!\n\n";
+    }
+    free_matrix(C_parallel);
+
     delete[] A;
     delete[] B;
     delete[] C_simple;
@@ -153,4 +555,4 @@ int main() {
     delete[] C_blocked;
 
     return 0;
-}
+}
\ No newline at end of file
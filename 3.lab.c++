@@ -8,227 +8,780 @@
 #include <chrono>
 #include <random>
 #include <cmath>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "thread_pool.h"
 using namespace std;
 using namespace std::chrono;
 
+// Аппаратные счётчики (Linux perf_event_open) включены в отладочной сборке
+// или с -DPERF_COUNTERS; в release-сборке (-DNDEBUG) они не компилируются
+// и PerformanceMeasure измеряет только время по монотонным часам.
+#if defined(__linux__) && (!defined(NDEBUG) || defined(PERF_COUNTERS))
+#define MAZE_HW_COUNTERS 1
+#endif
+
+struct PerfSample {
+    double time_ms = 0;
+    bool has_counters = false;
+    // -1, если счётчик недоступен
+    long long cycles = -1;
+    long long instructions = -1;
+    long long cache_misses = -1;
+    long long branch_misses = -1;
+};
+
 class PerformanceMeasure {
 private:
-    high_resolution_clock::time_point start_time;
-    long long operations_count = 0;
-    double flops_per_operation = 10.0;
+    steady_clock::time_point start_time;
+#ifdef MAZE_HW_COUNTERS
+    static const int COUNTERS = 4;
+    int fds[COUNTERS] = {-1, -1, -1, -1};
+    int slot[COUNTERS] = {-1, -1, -1, -1};
+    int opened = 0;
+
+    static int open_counter(uint64_t config, int group) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = group == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+    }
+#endif
 
 public:
-    void start() {
-        start_time = high_resolution_clock::now();
-        operations_count = 0;
+    PerformanceMeasure() {
+#ifdef MAZE_HW_COUNTERS
+        const uint64_t configs[COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < COUNTERS; ++i) {
+            fds[i] = open_counter(configs[i], i == 0 ? -1 : fds[0]);
+            if (fds[i] >= 0) slot[i] = opened++;
+            else if (i == 0) break;
+        }
+#endif
     }
 
-    void incrementOperations(long long count = 1) {
-        operations_count += count;
+    ~PerformanceMeasure() {
+#ifdef MAZE_HW_COUNTERS
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
     }
 
-    double getGFlops() const {
-        auto end_time = high_resolution_clock::now();
-        double duration = duration_cast<nanoseconds>(end_time - start_time).count() / 1e9;
-        if (duration == 0) return 0;
-        return (operations_count * flops_per_operation) / (duration * 1e9);
+    PerformanceMeasure(const PerformanceMeasure&) = delete;
+    PerformanceMeasure& operator=(const PerformanceMeasure&) = delete;
+
+    void start() {
+#ifdef MAZE_HW_COUNTERS
+        if (fds[0] >= 0) {
+            ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+        start_time = steady_clock::now();
     }
 
-    double getTimeMs() const {
-        auto end_time = high_resolution_clock::now();
-        return duration_cast<microseconds>(end_time - start_time).count() / 1000.0;
+    PerfSample stop() {
+        PerfSample sample;
+        auto end_time = steady_clock::now();
+        sample.time_ms = duration_cast<nanoseconds>(end_time - start_time).count() / 1e6;
+#ifdef MAZE_HW_COUNTERS
+        if (fds[0] >= 0) {
+            ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            uint64_t data[1 + COUNTERS] = {};
+            if (read(fds[0], data, sizeof(data)) > 0 && data[0] == (uint64_t)opened) {
+                long long* out[COUNTERS] = {&sample.cycles, &sample.instructions,
+                                            &sample.cache_misses, &sample.branch_misses};
+                for (int i = 0; i < COUNTERS; ++i) {
+                    if (slot[i] >= 0) *out[i] = (long long)data[1 + slot[i]];
+                }
+                sample.has_counters = true;
+            }
+        }
+#endif
+        return sample;
     }
 };
 
+// Лабиринт хранится побитово: строка - непрерывный ряд слов uint64_t,
+// бит 1 - стена. Вокруг сетки рамка из стен (строки -1 и N, столбцы -1 и M),
+// поэтому соседей любой клетки можно проверять без проверки границ.
 class Maze {
 private:
-    int N, M;
-    vector<vector<int>> grid;
+    int N = 0, M = 0;
+    int stride = 0;
+    vector<uint64_t> walls;
+
+    void allocate(int n, int m) {
+        N = n;
+        M = m;
+        stride = (M + 2 + 63) / 64;
+        walls.assign((size_t)(N + 2) * stride, ~0ULL);
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < M; ++j) setWall(i, j, false);
+        }
+    }
+
+    void setWall(int x, int y, bool wall) {
+        size_t bit = (size_t)(x + 1) * stride * 64 + (y + 1);
+        if (wall) walls[bit >> 6] |= 1ULL << (bit & 63);
+        else walls[bit >> 6] &= ~(1ULL << (bit & 63));
+    }
 
 public:
     void initFromInput() {
         cout << "Enter maze dimensions N and M: ";
-        cin >> N >> M;
+        int n, m;
+        cin >> n >> m;
 
-        if (N <= 0 || M <= 0) throw runtime_error("Maze dimensions must be positive");
+        if (n <= 0 || m <= 0) throw runtime_error("Maze dimensions must be positive");
         
-        grid.resize(N, vector<int>(M));
+        allocate(n, m);
         
         cout << "Enter maze (0 for path, 1 for wall), row by row:\n";
         for (int i = 0; i < N; ++i) {
             for (int j = 0; j < M; ++j) {
-                cin >> grid[i][j];
+                int cell;
+                cin >> cell;
+                setWall(i, j, cell != 0);
             }
         }
     }
 
-    void generateRandom(int n, int m, double wall_probability = 0.3) {
-        N = n;
-        M = m;
-        grid.resize(N, vector<int>(M));
+    // Одинаковый seed даёт одинаковый лабиринт
+    void generateRandom(int n, int m, double wall_probability = 0.3,
+                        unsigned seed = random_device{}()) {
+        allocate(n, m);
 
-        random_device rd;
-        mt19937 gen(rd());
+        mt19937 gen(seed);
         uniform_real_distribution<> dis(0, 1);
 
         for (int i = 0; i < N; ++i) {
             for (int j = 0; j < M; ++j) {
-                grid[i][j] = (dis(gen) < wall_probability) ? 1 : 0;
+                if (dis(gen) < wall_probability) setWall(i, j, true);
             }
         }
 
         int entries = min(N, M);
         for (int i = 0; i < entries; ++i) {
-            grid[0][i] = 0;
-            grid[N-1][i] = 0;
+            setWall(0, i, false);
+            setWall(N-1, i, false);
         }
     }
 
-    const vector<vector<int>>& getGrid() const { return grid; }
+    // x в [-1, N], y в [-1, M]: клетки рамки считаются стенами
+    bool isWall(int x, int y) const {
+        size_t bit = (size_t)(x + 1) * stride * 64 + (y + 1);
+        return (walls[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    // Номер клетки в плоском массиве размера cellCount() (с рамкой)
+    size_t cellIndex(int x, int y) const { return (size_t)(x + 1) * (M + 2) + (y + 1); }
+    size_t cellCount() const { return (size_t)(N + 2) * (M + 2); }
+
+    const uint64_t* wallBits() const { return walls.data(); }
+    int getStride() const { return stride; }
     int getN() const { return N; }
     int getM() const { return M; }
 
     void print() const {
         cout << "Maze layout (" << N << "x" << M << "):\n";
-        for (const auto& row : grid) {
-            for (int cell : row) {
-                cout << cell << " ";
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < M; ++j) {
+                cout << isWall(i, j) << " ";
             }
             cout << endl;
         }
     }
 };
 
-class MazeSolver {
-protected:
+// Сколько уровней последнего run() прошло каждым способом
+struct BFSLevelStats {
+    int top_down = 0;
+    int bottom_up = 0;
+    int parallel = 0;
+};
+
+// Поуровневый BFS над битовыми масками: фронт - битовая карта, за один шаг
+// обрабатывается целое слово из 64 клеток сдвигами.
+// Направление выбирается на каждом уровне по числу клеток: пока фронт
+// меньше 1/BOTTOM_UP_ALPHA ещё не посещённых открытых клеток, расширяются только
+// его непустые слова (сверху вниз), иначе каждое слово с непосещёнными клетками
+// собирает соседей из фронта (снизу вверх). Оба прохода делятся между потоками
+// постоянного пула: сверху вниз - по списку активных слов, снизу вверх - по строкам.
+// Для проверки достижимости без расстояний есть flood(): внутри слова
+// заливка идёт сразу до стен, поэтому слово обрабатывается считанные разы.
+class BitsetBFS {
+private:
+    static const int BOTTOM_UP_ALPHA = 4;
+    // Меньший объём работы на уровне выгоднее сделать в одном потоке
+    static const size_t PARALLEL_MIN_WORDS = 1 << 12;
+
     const Maze& maze;
-    vector<vector<bool>> global_used;
-    mutable PerformanceMeasure perf;
+    int N, stride;
+    size_t total_words;
+    ThreadPool pool;
+    vector<uint64_t> visited, frontier, next;
+    vector<size_t> active, visited_words;
+    // Списки слов, собранные каждым потоком за уровень
+    vector<vector<size_t>> local_touched, local_active;
+    BFSLevelStats stats;
+
+    // Заливка seeds по открытым клеткам open внутри слова в обе стороны
+    static uint64_t fill_row(uint64_t seeds, uint64_t open) {
+        uint64_t up = seeds, down = seeds, pu = open, pd = open;
+        for (int k = 1; k < 64; k <<= 1) {
+            up |= pu & (up << k);
+            pu &= pu << k;
+            down |= pd & (down >> k);
+            pd &= pd >> k;
+        }
+        return up | down;
+    }
+
+    bool bit(const vector<uint64_t>& bits, int x, int y) const {
+        size_t b = (size_t)(x + 1) * stride * 64 + (y + 1);
+        return (bits[b >> 6] >> (b & 63)) & 1;
+    }
+
+    // Сбор списков потоков в active
+    void join_active() {
+        active.clear();
+        for (auto& part : local_active) active.insert(active.end(), part.begin(), part.end());
+    }
+
+    // Сверху вниз: соседи каждого непустого слова фронта разносятся в next.
+    // Активные слова делятся между потоками поровну; соседние слова могут
+    // достаться разным потокам, поэтому запись в next - атомарное OR,
+    // и слово попадает в список того потока, который первым сделал его ненулевым.
+    void expand_top_down() {
+        const uint64_t* walls = maze.wallBits();
+        const bool parallel = pool.size() > 1 && active.size() >= PARALLEL_MIN_WORDS;
+        const int workers = parallel ? pool.size() : 1;
+        ++stats.top_down;
+        stats.parallel += parallel;
+
+        auto scatter = [&](int tid) {
+            vector<size_t>& touched = local_touched[tid];
+            touched.clear();
+            auto add = [&](size_t w, uint64_t bits) {
+                uint64_t old = parallel ? __atomic_fetch_or(&next[w], bits, __ATOMIC_RELAXED)
+                                        : exchange(next[w], next[w] | bits);
+                if (old == 0) touched.push_back(w);
+            };
+            size_t begin = active.size() * tid / workers, end = active.size() * (tid + 1) / workers;
+            for (size_t i = begin; i < end; ++i) {
+                size_t w = active[i];
+                uint64_t f = frontier[w];
+                add(w, (f << 1) | (f >> 1));
+                if (f >> 63) add(w + 1, 1);
+                if (f & 1) add(w - 1, 1ULL << 63);
+                add(w - stride, f);
+                add(w + stride, f);
+                frontier[w] = 0;
+            }
+        };
+        auto filter = [&](int tid) {
+            vector<size_t>& out = local_active[tid];
+            out.clear();
+            for (size_t w : local_touched[tid]) {
+                next[w] &= ~walls[w] & ~visited[w];
+                if (next[w]) out.push_back(w);
+            }
+        };
+        if (parallel) {
+            pool.run(scatter);
+            pool.run(filter);
+        } else {
+            for (auto& part : local_active) part.clear();
+            scatter(0);
+            filter(0);
+        }
+        join_active();
+    }
 
-    bool is_valid(int x, int y, const vector<vector<bool>>& visited) const {
-        perf.incrementOperations(6);
-        return x >= 0 && x < maze.getN() && y >= 0 && y < maze.getM() 
-               && maze.getGrid()[x][y] == 0 && !visited[x][y] && !global_used[x][y];
+    // Снизу вверх: каждое слово непосещённых клеток собирает соседей из фронта
+    void gather_rows(int row_begin, int row_end, vector<size_t>& out) {
+        const uint64_t* walls = maze.wallBits();
+        out.clear();
+        for (size_t w = (size_t)row_begin * stride; w < (size_t)row_end * stride; ++w) {
+            uint64_t candidates = ~walls[w] & ~visited[w];
+            if (!candidates) continue;
+            uint64_t f = frontier[w];
+            uint64_t nb = (f << 1) | (f >> 1) | (frontier[w - 1] >> 63) | (frontier[w + 1] << 63)
+                        | frontier[w - stride] | frontier[w + stride];
+            next[w] = nb & candidates;
+            if (next[w]) out.push_back(w);
+        }
+    }
+
+    void expand_bottom_up() {
+        const bool parallel = pool.size() > 1 && total_words >= PARALLEL_MIN_WORDS;
+        ++stats.bottom_up;
+        stats.parallel += parallel;
+        if (parallel) {
+            const int workers = pool.size();
+            pool.run([&](int tid) {
+                int begin = 1 + (int)((long long)N * tid / workers);
+                int end = 1 + (int)((long long)N * (tid + 1) / workers);
+                gather_rows(begin, end, local_active[tid]);
+            });
+        } else {
+            for (auto& part : local_active) part.clear();
+            gather_rows(1, N + 1, local_active[0]);
+        }
+        for (size_t w : active) frontier[w] = 0;
+        join_active();
     }
 
 public:
-    MazeSolver(const Maze& m) : maze(m) {
-        global_used.resize(maze.getN(), vector<bool>(maze.getM(), false));
+    BitsetBFS(const Maze& m, int threads = 1)
+        : maze(m), N(m.getN()), stride(m.getStride()), pool(threads),
+          local_touched(pool.size()), local_active(pool.size()) {
+        total_words = (size_t)(N + 2) * stride;
+        visited.assign(total_words, 0);
+        frontier.assign(total_words, 0);
+        next.assign(total_words, 0);
     }
 
-    virtual bool solve_a() = 0;
-    virtual bool solve_b() = 0;
-    virtual string implementationName() const = 0;
+    // BFS из (sx, sy). Останавливается, когда посещена клетка (tx, ty),
+    // если она задана, иначе обходит всю компоненту.
+    // Возвращает расстояние до цели (или число уровней) либо -1.
+    int run(int sx, int sy, int tx = -1, int ty = -1) {
+        // Очищаются только слова, затронутые прошлым обходом
+        for (size_t w : visited_words) visited[w] = 0;
+        for (size_t w : active) frontier[w] = 0;
+        visited_words.clear();
+        active.clear();
+        stats = BFSLevelStats();
+        if (maze.isWall(sx, sy)) return -1;
 
-    void resetGlobalUsed() {
-        global_used.assign(maze.getN(), vector<bool>(maze.getM(), false));
+        // Стены заполняют и рамку, и хвосты строк, так что открытые биты - это клетки
+        const uint64_t* walls = maze.wallBits();
+        long long unvisited = 0;
+        for (size_t w = 0; w < total_words; ++w) unvisited += __builtin_popcountll(~walls[w]);
+
+        size_t b = (size_t)(sx + 1) * stride * 64 + (sy + 1);
+        frontier[b >> 6] = 1ULL << (b & 63);
+        visited[b >> 6] = frontier[b >> 6];
+        active.push_back(b >> 6);
+        visited_words.push_back(b >> 6);
+        long long frontier_cells = 1;
+        unvisited -= 1;
+
+        int level = 0;
+        while (!active.empty()) {
+            if (tx >= 0 && bit(visited, tx, ty)) return level;
+            if (frontier_cells * BOTTOM_UP_ALPHA > unvisited) expand_bottom_up();
+            else expand_top_down();
+            swap(frontier, next);
+            frontier_cells = 0;
+            for (size_t w : active) {
+                if (!visited[w]) visited_words.push_back(w);
+                visited[w] |= frontier[w];
+                frontier_cells += __builtin_popcountll(frontier[w]);
+            }
+            unvisited -= frontier_cells;
+            ++level;
+        }
+        if (tx >= 0) return bit(visited, tx, ty) ? level : -1;
+        return level;
     }
 
-    void performanceTest() {
-        cout << implementationName() << " Results:\n";
-        
-        perf.start();
-        bool a_result = solve_a();
-        double a_time = perf.getTimeMs();
-        double a_gflops = perf.getGFlops();
-        
-        perf.start();
-        bool b_result = solve_b();
-        double b_time = perf.getTimeMs();
-        double b_gflops = perf.getGFlops();
+    const BFSLevelStats& levelStats() const { return stats; }
+
+    // Заливка компоненты клетки (sx, sy) без подсчёта уровней
+    void flood(int sx, int sy) {
+        for (size_t w : visited_words) visited[w] = 0;
+        for (size_t w : active) frontier[w] = 0;
+        visited_words.clear();
+        active.clear();
+        if (maze.isWall(sx, sy)) return;
+
+        const uint64_t* walls = maze.wallBits();
+        size_t b = (size_t)(sx + 1) * stride * 64 + (sy + 1);
+        visited[b >> 6] = 1ULL << (b & 63);
+        visited_words.push_back(b >> 6);
+        vector<size_t> pending = {b >> 6};
 
-        cout << "  Solution A: " << (a_result ? "Possible" : "Impossible") 
-             << " (" << a_time << " ms, " << a_gflops << " GFLOPs)\n";
-        cout << "  Solution B: " << (b_result ? "Possible" : "Impossible") 
-             << " (" << b_time << " ms, " << b_gflops << " GFLOPs)\n";
+        auto spread = [&](size_t w, uint64_t bits) {
+            bits &= ~walls[w] & ~visited[w];
+            if (!bits) return;
+            if (!visited[w]) visited_words.push_back(w);
+            visited[w] |= bits;
+            pending.push_back(w);
+        };
+        while (!pending.empty()) {
+            size_t w = pending.back();
+            pending.pop_back();
+            uint64_t row = fill_row(visited[w], ~walls[w]);
+            visited[w] = row;
+            spread(w - stride, row);
+            spread(w + stride, row);
+            spread(w + 1, row >> 63);
+            spread(w - 1, row << 63);
+        }
     }
+
+    bool reached(int x, int y) const { return bit(visited, x, y); }
 };
 
-class ArraySolver : public MazeSolver {
+// Поиск вершинно-непересекающихся путей от входов (верхняя строка) к выходам
+// (нижняя строка) одним вычислением максимального потока.
+// Каждая клетка расщеплена на вершины in/out с ребром пропускной способности 1,
+// граф не хранится явно: остаточные рёбра вычисляются по состоянию потока
+// в клетках. Сетка хранится с рамкой из стен, поэтому соседи - это смещения
+// без проверок границ.
+// Сначала входы слева направо прокладываются жадно поиском "правой рукой"
+// (путь прижимается к уже проложенным слева), каждая клетка посещается один раз.
+// Затем для каждого незанятого входа ищется увеличивающий путь DFS
+// в остаточной сети, что гарантирует максимальность потока.
+// Если поиск неудачен, все посещённые вершины не достигают стока и не смогут
+// достичь его после следующих увеличений, поэтому они исключаются навсегда:
+// суммарная стоимость неудачных поисков - O(N*M).
+class DisjointPathsFlow {
 private:
-    static const int MAX_N = 100;
-    static const int MAX_M = 100;
+    static constexpr uint8_t NONE = 7;
+    static constexpr uint8_t SOURCE = 4;
+    static constexpr uint8_t SINK = 4;
+    static constexpr int DEAD = -1;
 
-    bool bfs(const pair<int, int>& start, const pair<int, int>& end, bool mark_used) {
-        vector<vector<bool>> visited(maze.getN(), vector<bool>(maze.getM(), false));
-        queue<pair<int, int>> q;
-        q.push(start);
-        visited[start.first][start.second] = true;
-        perf.incrementOperations(5);
+    int N, M, W, entries;
+    int T;
+    int offset[4];
+    vector<uint8_t> open;
 
-        int dx[] = {-1, 1, 0, 0};
-        int dy[] = {0, 0, -1, 1};
+    // Направление, куда уходит поток из клетки (0..3 или SINK),
+    // и откуда он пришёл (0..3 или SOURCE)
+    vector<uint8_t> next_dir, prev_dir;
+    vector<int> stamp;
+    vector<uint8_t> arc;
+    vector<int> path, visited;
 
-        while (!q.empty()) {
-            auto [x, y] = q.front();
-            q.pop();
-            perf.incrementOperations(3);
+    static uint8_t opposite(uint8_t d) { return d ^ 1; }
 
-            if (x == end.first && y == end.second) {
-                if (mark_used) {
-                    for (int i = 0; i < maze.getN(); ++i) {
-                        for (int j = 0; j < maze.getM(); ++j) {
-                            if (visited[i][j]) global_used[i][j] = true;
-                            perf.incrementOperations(3);
-                        }
+    int cell_of(int x, int y) const { return (x + 1) * W + y + 1; }
+    bool is_exit(int cell) const { return cell / W == N && cell % W <= entries; }
+
+    // Вершина, в которую ведёт k-е остаточное ребро из v, или -1.
+    // in(c):  0 - in(c)->out(c), если клетка свободна; 1 - отмена потока prev->c
+    // out(c): 0 - в сток; 1..4 - к соседям (вниз, влево, вправо, вверх);
+    //         5 - отмена внутреннего ребра c
+    int residual_target(int v, int k) const {
+        static constexpr uint8_t order[] = {1, 2, 3, 0};
+        int cell = v >> 1;
+        if ((v & 1) == 0) {
+            if (k == 0) return next_dir[cell] == NONE ? v | 1 : -1;
+            if (k == 1 && prev_dir[cell] < 4) {
+                return 2 * (cell + offset[prev_dir[cell]]) + 1;
+            }
+            return -1;
+        }
+        if (k == 0) return is_exit(cell) && next_dir[cell] != SINK ? T : -1;
+        if (k <= 4) {
+            uint8_t d = order[k - 1];
+            int nb = cell + offset[d];
+            return open[nb] && next_dir[cell] != d ? 2 * nb : -1;
+        }
+        return prev_dir[cell] != NONE ? v & ~1 : -1;
+    }
+
+    static int arc_count(int v) { return (v & 1) ? 6 : 2; }
+
+    // Применение найденного пути: сначала отмены старого потока, затем новые рёбра
+    void augment() {
+        for (size_t p = 0; p + 1 < path.size(); ++p) {
+            int v = path[p], w = path[p + 1];
+            if ((v & 1) == 0 && (w & 1) == 1 && (w >> 1) != (v >> 1)) {
+                next_dir[w >> 1] = NONE;
+                prev_dir[v >> 1] = NONE;
+            }
+        }
+        prev_dir[path[0] >> 1] = SOURCE;
+        for (size_t p = 0; p + 1 < path.size(); ++p) {
+            int v = path[p], w = path[p + 1];
+            if (w == T) {
+                next_dir[v >> 1] = SINK;
+            } else if ((v & 1) == 1 && (w & 1) == 0 && (w >> 1) != (v >> 1)) {
+                int from = v >> 1, to = w >> 1;
+                uint8_t d = 0;
+                while (from + offset[d] != to) ++d;
+                next_dir[from] = d;
+                prev_dir[to] = opposite(d);
+            }
+        }
+    }
+
+    // Жадная прокладка путей: DFS по клеткам, на каждом шаге сначала поворот
+    // направо относительно направления движения, затем прямо, затем налево.
+    // Посещённые клетки не посещаются повторно ни в одном из поисков.
+    int greedy_routes() {
+        static constexpr uint8_t right_of[] = {3, 2, 0, 1};
+        static constexpr uint8_t left_of[] = {2, 3, 1, 0};
+        vector<uint8_t> seen(open.size(), 0);
+        vector<pair<int, uint8_t>> stack;
+        vector<uint8_t> tried(open.size(), 0);
+        int routed = 0;
+
+        for (int i = 0; i < entries; ++i) {
+            int start = cell_of(0, i);
+            if (!open[start] || seen[start]) continue;
+            stack.assign(1, {start, 1});
+            seen[start] = 1;
+            tried[start] = 0;
+            while (!stack.empty()) {
+                auto [cell, heading] = stack.back();
+                if (is_exit(cell)) break;
+                const uint8_t order[] = {right_of[heading], heading, left_of[heading], opposite(heading)};
+                int next = -1;
+                while (tried[cell] < 4) {
+                    uint8_t d = order[tried[cell]++];
+                    int nb = cell + offset[d];
+                    if (open[nb] && !seen[nb]) {
+                        next = nb;
+                        seen[nb] = 1;
+                        tried[nb] = 0;
+                        stack.push_back({nb, d});
+                        break;
                     }
                 }
-                perf.incrementOperations(2);
-                return true;
+                if (next < 0) stack.pop_back();
             }
+            if (stack.empty()) continue;
 
-            for (int i = 0; i < 4; ++i) {
-                int nx = x + dx[i];
-                int ny = y + dy[i];
-                perf.incrementOperations(2);
+            prev_dir[start] = SOURCE;
+            for (size_t p = 1; p < stack.size(); ++p) {
+                uint8_t d = stack[p].second;
+                next_dir[stack[p - 1].first] = d;
+                prev_dir[stack[p].first] = opposite(d);
+            }
+            next_dir[stack.back().first] = SINK;
+            ++routed;
+        }
+        return routed;
+    }
 
-                if (is_valid(nx, ny, visited)) {
-                    visited[nx][ny] = true;
-                    q.push({nx, ny});
-                    perf.incrementOperations(3);
+    // Итеративный DFS по остаточной сети из вершины start
+    bool search(int start, int id) {
+        path.assign(1, start);
+        visited.assign(1, start);
+        stamp[start] = id;
+        arc[start] = 0;
+        while (!path.empty()) {
+            int v = path.back();
+            if (v == T) {
+                augment();
+                return true;
+            }
+            int w = -1;
+            for (; arc[v] < arc_count(v); ++arc[v]) {
+                int t = residual_target(v, arc[v]);
+                if (t >= 0 && stamp[t] != id && stamp[t] != DEAD) {
+                    w = t;
+                    break;
                 }
             }
+            if (w < 0) {
+                path.pop_back();
+                continue;
+            }
+            stamp[w] = id;
+            if (w != T) {
+                arc[w] = 0;
+                visited.push_back(w);
+            }
+            path.push_back(w);
         }
+        for (int v : visited) stamp[v] = DEAD;
         return false;
     }
 
 public:
-    ArraySolver(const Maze& m) : MazeSolver(m) {
-        if (maze.getN() > MAX_N || maze.getM() > MAX_M) 
-            throw runtime_error("Size too large for array implementation");
+    DisjointPathsFlow(const Maze& maze)
+        : N(maze.getN()), M(maze.getM()), W(maze.getM() + 2),
+          entries(min(maze.getN(), maze.getM())) {
+        size_t cells = (size_t)(N + 2) * W;
+        T = (int)(2 * cells);
+        offset[0] = -W;
+        offset[1] = W;
+        offset[2] = -1;
+        offset[3] = 1;
+        open.assign(cells, 0);
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < M; ++j) {
+                open[cell_of(i, j)] = !maze.isWall(i, j);
+            }
+        }
+        next_dir.assign(cells, NONE);
+        prev_dir.assign(cells, NONE);
+        stamp.assign(2 * cells + 1, 0);
+        arc.assign(2 * cells + 1, 0);
     }
 
-    bool solve_a() override {
+    // Максимальное число непересекающихся путей
+    int maxFlow() {
+        int flow = greedy_routes();
+        for (int i = 0; i < entries; ++i) {
+            int start = 2 * cell_of(0, i);
+            if (!open[start >> 1] || prev_dir[start >> 1] == SOURCE || stamp[start] == DEAD) continue;
+            if (search(start, i + 1)) ++flow;
+        }
+        return flow;
+    }
+
+    // Найденные маршруты (по одному на каждый вход, через который идёт поток)
+    vector<vector<pair<int, int>>> routes() const {
+        vector<vector<pair<int, int>>> result;
+        for (int i = 0; i < entries; ++i) {
+            int cell = cell_of(0, i);
+            if (prev_dir[cell] != SOURCE) continue;
+            vector<pair<int, int>> route;
+            while (true) {
+                route.push_back({cell / W - 1, cell % W - 1});
+                if (next_dir[cell] == SINK) break;
+                cell += offset[next_dir[cell]];
+            }
+            result.push_back(route);
+        }
+        return result;
+    }
+};
+
+class MazeSolver {
+protected:
+    const Maze& maze;
+    vector<bool> global_used;
+    vector<vector<pair<int, int>>> routes;
+
+    // Соседи клеток сетки всегда лежат в рамке, поэтому проверки границ не нужны
+    bool is_valid(int x, int y, const vector<bool>& visited) const {
+        size_t c = maze.cellIndex(x, y);
+        return !maze.isWall(x, y) && !visited[c] && !global_used[c];
+    }
+
+public:
+    MazeSolver(const Maze& m) : maze(m) {
+        global_used.assign(maze.cellCount(), false);
+    }
+
+    virtual bool solve_a() = 0;
+    virtual string implementationName() const = 0;
+
+    // Каждый вход должен дойти до своего, отличного от других, выхода
+    // по непересекающимся путям. Клетки найденных маршрутов помечаются в global_used.
+    virtual bool solve_b() {
         resetGlobalUsed();
+        routes.clear();
         int entries = min(maze.getN(), maze.getM());
         for (int i = 0; i < entries; ++i) {
-            if (maze.getGrid()[0][i] != 0 || maze.getGrid()[maze.getN()-1][i] != 0) 
-                return false;
-            
-            if (!bfs({0, i}, {maze.getN()-1, i}, false))
-                return false;
+            if (maze.isWall(0, i)) return false;
+        }
+
+        DisjointPathsFlow flow(maze);
+        if (flow.maxFlow() < entries) return false;
+
+        routes = flow.routes();
+        for (const auto& route : routes) {
+            for (const auto& [x, y] : route) global_used[maze.cellIndex(x, y)] = true;
         }
         return true;
     }
 
-    bool solve_b() override {
+    const vector<vector<pair<int, int>>>& getRoutes() const { return routes; }
+
+    void resetGlobalUsed() {
+        global_used.assign(maze.cellCount(), false);
+    }
+
+    void printRoutes() const {
+        for (size_t r = 0; r < routes.size(); ++r) {
+            cout << "  Route " << r + 1 << ":";
+            for (const auto& [x, y] : routes[r]) cout << " (" << x << "," << y << ")";
+            cout << endl;
+        }
+    }
+
+    static void printSample(const PerfSample& s) {
+        cout << s.time_ms << " ms";
+        if (!s.has_counters) return;
+        if (s.cycles >= 0) cout << ", " << s.cycles << " cycles";
+        if (s.instructions >= 0) cout << ", " << s.instructions << " instructions";
+        if (s.cycles > 0 && s.instructions >= 0) cout << ", IPC " << (double)s.instructions / s.cycles;
+        if (s.cache_misses >= 0) cout << ", " << s.cache_misses << " cache misses";
+        if (s.branch_misses >= 0) cout << ", " << s.branch_misses << " branch misses";
+    }
+
+    void performanceTest() {
+        cout << implementationName() << " Results:\n";
+        
+        PerformanceMeasure perf;
+        perf.start();
+        bool a_result = solve_a();
+        PerfSample a = perf.stop();
+        
+        perf.start();
+        bool b_result = solve_b();
+        PerfSample b = perf.stop();
+
+        cout << "  Solution A: " << (a_result ? "Possible" : "Impossible") << " (";
+        printSample(a);
+        cout << ")\n";
+        cout << "  Solution B: " << (b_result ? "Possible" : "Impossible") << " (";
+        printSample(b);
+        cout << ")\n";
+        if (b_result && maze.getN() * maze.getM() <= 400) printRoutes();
+    }
+};
+
+// Хранение в плоских битовых массивах, BFS по словам из 64 клеток
+class ArraySolver : public MazeSolver {
+private:
+    BitsetBFS bfs;
+
+public:
+    ArraySolver(const Maze& m, int threads = 1) : MazeSolver(m), bfs(m, threads) {}
+
+    // Одна заливка на связную компоненту: все входы, достигнутые из входа i,
+    // проверяются по тем же посещённым клеткам
+    bool solve_a() override {
         resetGlobalUsed();
         int entries = min(maze.getN(), maze.getM());
+        vector<bool> checked(entries, false);
         for (int i = 0; i < entries; ++i) {
-            if (maze.getGrid()[0][i] != 0) return false;
-            bool found = false;
-            for (int j = 0; j < entries; ++j) {
-                if (maze.getGrid()[maze.getN()-1][j] == 0 && 
-                    bfs({0, i}, {maze.getN()-1, j}, false)) {
-                    found = true;
-                    break;
-                }
+            if (maze.isWall(0, i) || maze.isWall(maze.getN()-1, i)) 
+                return false;
+            if (checked[i]) continue;
+
+            bfs.flood(0, i);
+            for (int j = i; j < entries; ++j) {
+                if (!bfs.reached(0, j)) continue;
+                if (!bfs.reached(maze.getN()-1, j)) return false;
+                checked[j] = true;
             }
-            if (!found) return false;
         }
         return true;
     }
 
+    // Длина кратчайшего пути между клетками или -1
+    int shortestPath(int sx, int sy, int tx, int ty) { return bfs.run(sx, sy, tx, ty); }
+    const BFSLevelStats& shortestPathStats() const { return bfs.levelStats(); }
+
     string implementationName() const override { return "Array Implementation"; }
 };
 
@@ -241,16 +794,14 @@ private:
     };
 
     Node* create_node(int x, int y) {
-        perf.incrementOperations(5);
         return new Node{x, y, nullptr, nullptr};
     }
 
-    bool bfs(const pair<int, int>& start, const pair<int, int>& end, bool mark_used) {
-        vector<vector<bool>> visited(maze.getN(), vector<bool>(maze.getM(), false));
+    bool bfs(const pair<int, int>& start, const pair<int, int>& end) {
+        vector<bool> visited(maze.cellCount(), false);
         Node* front = create_node(start.first, start.second);
         Node* rear = front;
-        visited[start.first][start.second] = true;
-        perf.incrementOperations(5);
+        visited[maze.cellIndex(start.first, start.second)] = true;
 
         int dx[] = {-1, 1, 0, 0};
         int dy[] = {0, 0, -1, 1};
@@ -258,52 +809,37 @@ private:
         while (front != nullptr) {
             Node* current = front;
             front = front->next;
-            perf.incrementOperations(3);
             
             int x = current->x;
             int y = current->y;
 
             if (x == end.first && y == end.second) {
-                if (mark_used) {
-                    for (int i = 0; i < maze.getN(); ++i) {
-                        for (int j = 0; j < maze.getM(); ++j) {
-                            if (visited[i][j]) global_used[i][j] = true;
-                            perf.incrementOperations(3);
-                        }
-                    }
-                }
                 while (front != nullptr) {
                     Node* temp = front;
                     front = front->next;
                     delete temp;
-                    perf.incrementOperations(4);
                 }
                 delete current;
-                perf.incrementOperations(2);
                 return true;
             }
 
             for (int i = 0; i < 4; ++i) {
                 int nx = x + dx[i];
                 int ny = y + dy[i];
-                perf.incrementOperations(2);
 
                 if (is_valid(nx, ny, visited)) {
-                    visited[nx][ny] = true;
+                    visited[maze.cellIndex(nx, ny)] = true;
                     Node* new_node = create_node(nx, ny);
                     if (front == nullptr) {
                         front = rear = new_node;
-                        perf.incrementOperations(2);
                     } else {
                         rear->next = new_node;
                         new_node->prev = rear;
                         rear = new_node;
-                        perf.incrementOperations(4);
                     }
                 }
             }
             delete current;
-            perf.incrementOperations(1);
         }
         return false;
     }
@@ -315,33 +851,15 @@ public:
         resetGlobalUsed();
         int entries = min(maze.getN(), maze.getM());
         for (int i = 0; i < entries; ++i) {
-            if (maze.getGrid()[0][i] != 0 || maze.getGrid()[maze.getN()-1][i] != 0) 
+            if (maze.isWall(0, i) || maze.isWall(maze.getN()-1, i)) 
                 return false;
             
-            if (!bfs({0, i}, {maze.getN()-1, i}, false))
+            if (!bfs({0, i}, {maze.getN()-1, i}))
                 return false;
         }
         return true;
     }
 
-    bool solve_b() override {
-        resetGlobalUsed();
-        int entries = min(maze.getN(), maze.getM());
-        for (int i = 0; i < entries; ++i) {
-            if (maze.getGrid()[0][i] != 0) return false;
-            bool found = false;
-            for (int j = 0; j < entries; ++j) {
-                if (maze.getGrid()[maze.getN()-1][j] == 0 && 
-                    bfs({0, i}, {maze.getN()-1, j}, false)) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) return false;
-        }
-        return true;
-    }
-
     string implementationName() const override { return "Linked List Implementation"; }
 };
 
@@ -349,12 +867,11 @@ class STLSolver : public MazeSolver {
 public:
     STLSolver(const Maze& m) : MazeSolver(m) {}
 
-    bool bfs(const pair<int, int>& start, const pair<int, int>& end, bool mark_used) {
-        vector<vector<bool>> visited(maze.getN(), vector<bool>(maze.getM(), false));
+    bool bfs(const pair<int, int>& start, const pair<int, int>& end) {
+        vector<bool> visited(maze.cellCount(), false);
         queue<pair<int, int>> q;
         q.push(start);
-        visited[start.first][start.second] = true;
-        perf.incrementOperations(5);
+        visited[maze.cellIndex(start.first, start.second)] = true;
 
         int dx[] = {-1, 1, 0, 0};
         int dy[] = {0, 0, -1, 1};
@@ -362,29 +879,18 @@ public:
         while (!q.empty()) {
             auto [x, y] = q.front();
             q.pop();
-            perf.incrementOperations(3);
 
             if (x == end.first && y == end.second) {
-                if (mark_used) {
-                    for (int i = 0; i < maze.getN(); ++i) {
-                        for (int j = 0; j < maze.getM(); ++j) {
-                            if (visited[i][j]) global_used[i][j] = true;
-                            perf.incrementOperations(3);
-                        }
-                    }
-                }
                 return true;
             }
 
             for (int i = 0; i < 4; ++i) {
                 int nx = x + dx[i];
                 int ny = y + dy[i];
-                perf.incrementOperations(2);
 
                 if (is_valid(nx, ny, visited)) {
-                    visited[nx][ny] = true;
+                    visited[maze.cellIndex(nx, ny)] = true;
                     q.push({nx, ny});
-                    perf.incrementOperations(3);
                 }
             }
         }
@@ -395,33 +901,15 @@ public:
         resetGlobalUsed();
         int entries = min(maze.getN(), maze.getM());
         for (int i = 0; i < entries; ++i) {
-            if (maze.getGrid()[0][i] != 0 || maze.getGrid()[maze.getN()-1][i] != 0) 
+            if (maze.isWall(0, i) || maze.isWall(maze.getN()-1, i)) 
                 return false;
             
-            if (!bfs({0, i}, {maze.getN()-1, i}, false))
+            if (!bfs({0, i}, {maze.getN()-1, i}))
                 return false;
         }
         return true;
     }
 
-    bool solve_b() override {
-        resetGlobalUsed();
-        int entries = min(maze.getN(), maze.getM());
-        for (int i = 0; i < entries; ++i) {
-            if (maze.getGrid()[0][i] != 0) return false;
-            bool found = false;
-            for (int j = 0; j < entries; ++j) {
-                if (maze.getGrid()[maze.getN()-1][j] == 0 && 
-                    bfs({0, i}, {maze.getN()-1, j}, false)) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) return false;
-        }
-        return true;
-    }
-
     string implementationName() const override { return "STL Implementation"; }
 };
 
@@ -450,17 +938,197 @@ void compareImplementations(Maze& maze) {
     }
 }
 
-int main() {
+// Набор бенчмарков: лабиринты растущего размера с фиксированным seed,
+// прогрев, повторы, медиана и 99-й перцентиль времени
+struct BenchmarkResult {
+    int size;
+    string implementation;
+    char solution;
+    bool possible;
+    double median_ms;
+    double p99_ms;
+    PerfSample counters;
+};
+
+// Перцентиль по ближайшему рангу
+template <typename T>
+T percentile(vector<T> values, double p) {
+    sort(values.begin(), values.end());
+    size_t rank = (size_t)ceil(p / 100.0 * values.size());
+    return values[rank > 0 ? rank - 1 : 0];
+}
+
+vector<BenchmarkResult> runBenchmarks(const vector<int>& sizes, int warmup, int repetitions, unsigned seed) {
+    const vector<function<unique_ptr<MazeSolver>(const Maze&)>> factories = {
+        [](const Maze& m) { return unique_ptr<MazeSolver>(new ArraySolver(m)); },
+        [](const Maze& m) { return unique_ptr<MazeSolver>(new LinkedListSolver(m)); },
+        [](const Maze& m) { return unique_ptr<MazeSolver>(new STLSolver(m)); },
+    };
+
+    vector<BenchmarkResult> results;
+    PerformanceMeasure perf;
+    for (int size : sizes) {
+        Maze maze;
+        maze.generateRandom(size, size, 0.3, seed);
+        for (const auto& make : factories) {
+            unique_ptr<MazeSolver> solver = make(maze);
+            for (char solution : {'A', 'B'}) {
+                auto solve = [&] { return solution == 'A' ? solver->solve_a() : solver->solve_b(); };
+                for (int w = 0; w < warmup; ++w) solve();
+
+                bool possible = false;
+                vector<PerfSample> samples;
+                for (int r = 0; r < repetitions; ++r) {
+                    perf.start();
+                    possible = solve();
+                    samples.push_back(perf.stop());
+                }
+
+                vector<double> times;
+                vector<long long> cycles, instructions, cache_misses, branch_misses;
+                for (const auto& s : samples) {
+                    times.push_back(s.time_ms);
+                    cycles.push_back(s.cycles);
+                    instructions.push_back(s.instructions);
+                    cache_misses.push_back(s.cache_misses);
+                    branch_misses.push_back(s.branch_misses);
+                }
+                PerfSample counters;
+                counters.has_counters = samples.front().has_counters;
+                counters.cycles = percentile(cycles, 50);
+                counters.instructions = percentile(instructions, 50);
+                counters.cache_misses = percentile(cache_misses, 50);
+                counters.branch_misses = percentile(branch_misses, 50);
+
+                results.push_back({size, solver->implementationName(), solution, possible,
+                                   percentile(times, 50), percentile(times, 99), counters});
+            }
+        }
+    }
+    return results;
+}
+
+void printBenchmarksTable(const vector<BenchmarkResult>& results) {
+    for (const auto& r : results) {
+        cout << r.size << "x" << r.size << " " << r.implementation << " " << r.solution << ": "
+             << (r.possible ? "Possible" : "Impossible")
+             << ", median " << r.median_ms << " ms, p99 " << r.p99_ms << " ms";
+        if (r.counters.has_counters) {
+            cout << " (";
+            MazeSolver::printSample(r.counters);
+            cout << ")";
+        }
+        cout << endl;
+    }
+}
+
+// Недоступные счётчики выводятся пустыми полями
+void printBenchmarksCsv(const vector<BenchmarkResult>& results) {
+    auto counter = [](long long value) { return value >= 0 ? to_string(value) : string(); };
+    cout << "size,implementation,solution,possible,median_ms,p99_ms,"
+            "cycles,instructions,cache_misses,branch_misses\n";
+    for (const auto& r : results) {
+        cout << r.size << "," << r.implementation << "," << r.solution << ","
+             << r.possible << "," << r.median_ms << "," << r.p99_ms << ","
+             << counter(r.counters.cycles) << "," << counter(r.counters.instructions) << ","
+             << counter(r.counters.cache_misses) << "," << counter(r.counters.branch_misses) << "\n";
+    }
+}
+
+// Недоступные счётчики выводятся как null, ключи есть всегда (как столбцы CSV)
+void printBenchmarksJson(const vector<BenchmarkResult>& results) {
+    auto counter = [](long long value) { return value >= 0 ? to_string(value) : string("null"); };
+    cout << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        cout << "  {\"size\": " << r.size
+             << ", \"implementation\": \"" << r.implementation << "\""
+             << ", \"solution\": \"" << r.solution << "\""
+             << ", \"possible\": " << (r.possible ? "true" : "false")
+             << ", \"median_ms\": " << r.median_ms
+             << ", \"p99_ms\": " << r.p99_ms;
+        cout << ", \"cycles\": " << counter(r.counters.cycles)
+             << ", \"instructions\": " << counter(r.counters.instructions)
+             << ", \"cache_misses\": " << counter(r.counters.cache_misses)
+             << ", \"branch_misses\": " << counter(r.counters.branch_misses);
+        cout << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    cout << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    // --bench [--csv|--json] [--reps N] [--warmup N] [--seed S] [размеры...]
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        string format = "table";
+        int repetitions = 10, warmup = 2;
+        unsigned seed = 42;
+        vector<int> sizes;
+        for (int a = 2; a < argc; ++a) {
+            string arg = argv[a];
+            if (arg == "--csv") format = "csv";
+            else if (arg == "--json") format = "json";
+            else if (arg == "--reps" && a + 1 < argc) repetitions = max(1, atoi(argv[++a]));
+            else if (arg == "--warmup" && a + 1 < argc) warmup = max(0, atoi(argv[++a]));
+            else if (arg == "--seed" && a + 1 < argc) seed = (unsigned)strtoul(argv[++a], nullptr, 10);
+            else if (atoi(arg.c_str()) > 0) sizes.push_back(atoi(arg.c_str()));
+        }
+        if (sizes.empty()) sizes = {32, 64, 128, 256};
+
+        auto results = runBenchmarks(sizes, warmup, repetitions, seed);
+        if (format == "csv") printBenchmarksCsv(results);
+        else if (format == "json") printBenchmarksJson(results);
+        else printBenchmarksTable(results);
+        return 0;
+    }
+
     int choice;
     cout << "Choose input method:\n";
     cout << "1. Manual input\n";
     cout << "2. Random generated maze (50x50)\n";
+    cout << "3. Large random maze (array solver and disjoint paths)\n";
     cout << "Enter choice: ";
     cin >> choice;
 
     Maze maze;
 
     try {
+        if (choice == 3) {
+            int n, m;
+            cout << "Enter maze dimensions N and M: ";
+            cin >> n >> m;
+            if (n <= 0 || m <= 0) throw runtime_error("Maze dimensions must be positive");
+            maze.generateRandom(n, m);
+
+            ArraySolver solver(maze, max(1, (int)thread::hardware_concurrency()));
+            auto start = high_resolution_clock::now();
+            bool a_result = solver.solve_a();
+            double ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+            cout << "Solution A (bitset BFS): " << (a_result ? "Possible" : "Impossible")
+                 << " (" << ms << " ms)\n";
+
+            start = high_resolution_clock::now();
+            int distance = solver.shortestPath(0, 0, n - 1, 0);
+            ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+            cout << "Shortest path from entry 1 to exit 1: " << distance << " (" << ms << " ms)\n";
+            const BFSLevelStats& levels = solver.shortestPathStats();
+            cout << "  BFS levels: " << levels.top_down << " top-down, " << levels.bottom_up
+                 << " bottom-up, " << levels.parallel << " parallel\n";
+
+            // Движку потока нужно около 13 байт на клетку
+            const long long FLOW_MAX_CELLS = 50000000;
+            if ((long long)n * m > FLOW_MAX_CELLS) {
+                cout << "Solution B: skipped, maze too large for the flow solver\n";
+                return 0;
+            }
+            start = high_resolution_clock::now();
+            DisjointPathsFlow flow(maze);
+            int paths = flow.maxFlow();
+            ms = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+            cout << "Disjoint paths: " << paths << " of " << min(n, m)
+                 << " (" << ms << " ms)\n";
+            cout << "Solution B: " << (paths == min(n, m) ? "Possible" : "Impossible") << endl;
+            return 0;
+        }
         if (choice == 1) {
             maze.initFromInput();
         } else {
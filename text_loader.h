@@ -0,0 +1,240 @@
+//Shabarov Vladimir 090304-RPIa-024
+#pragma once
+
+// Общий загрузчик текстов для 4.lab и 5.lab.
+// Файл отображается в память, строки и слова - string_view прямо в отображение,
+// текст не перекодируется и остаётся в UTF-8. Перевод в нижний регистр
+// и классификация символов для ASCII и кириллицы идут по таблицам.
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cwctype>
+#include <fstream>
+#include <iterator>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TEXT_LOADER_MMAP 1
+#endif
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+// Файл, отображённый в память только для чтения.
+// Без mmap (не POSIX-системы) содержимое читается в буфер целиком.
+class MappedFile {
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+#ifdef TEXT_LOADER_MMAP
+    void* mapping = nullptr;
+#else
+    std::string buffer;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef TEXT_LOADER_MMAP
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            size = (size_t)st.st_size;
+            if (size == 0) {
+                opened = true;
+            } else {
+                void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    madvise(p, size, MADV_SEQUENTIAL);
+                    mapping = p;
+                    data = static_cast<const char*>(p);
+                    opened = true;
+                }
+            }
+        }
+        close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return;
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+        opened = true;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef TEXT_LOADER_MMAP
+        if (mapping) munmap(mapping, size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return opened; }
+    std::string_view text() const { return std::string_view(data, size); }
+};
+
+// Строки текста без завершающих '\r' (как getline: пустая строка в конце не создаётся)
+inline std::vector<std::string_view> splitLines(std::string_view text) {
+    std::vector<std::string_view> lines;
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view line = text.substr(begin, end - begin);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        lines.push_back(line);
+        begin = end + 1;
+    }
+    return lines;
+}
+
+inline bool isSpaceByte(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// Декодирование одного символа UTF-8 с позиции pos; некорректный байт даёт U+FFFD
+inline char32_t decodeUtf8(std::string_view s, size_t& pos) {
+    unsigned char c = s[pos];
+    if (c < 0x80) {
+        ++pos;
+        return c;
+    }
+    int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : -1;
+    if (extra < 0 || pos + extra >= s.size()) {
+        ++pos;
+        return 0xFFFD;
+    }
+    char32_t cp = c & (0x3F >> extra);
+    for (int i = 1; i <= extra; ++i) {
+        unsigned char next = s[pos + i];
+        if ((next & 0xC0) != 0x80) {
+            ++pos;
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (next & 0x3F);
+    }
+    pos += extra + 1;
+    return cp;
+}
+
+inline void appendUtf8(std::string& out, char32_t cp) {
+    if (cp < 0x80) {
+        out += (char)cp;
+    } else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// Число символов (не байтов) в строке UTF-8
+inline size_t utf8Length(std::string_view s) {
+    size_t n = 0;
+    for (char c : s) n += ((unsigned char)c & 0xC0) != 0x80;
+    return n;
+}
+
+// Таблицы для ASCII и основного блока кириллицы U+0400..U+047F
+// (в UTF-8 это двухбайтовые последовательности с ведущими байтами D0 и D1;
+// все символы этого диапазона - буквы)
+struct Utf8CaseTables {
+    char ascii_lower[128];
+    bool ascii_alnum[128];
+    char16_t cyrillic_lower[128];
+
+    Utf8CaseTables() {
+        for (int c = 0; c < 128; ++c) {
+            ascii_lower[c] = (c >= 'A' && c <= 'Z') ? (char)(c + 32) : (char)c;
+            ascii_alnum[c] = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        }
+        for (int i = 0; i < 128; ++i) {
+            char16_t cp = (char16_t)(0x400 + i);
+            if (cp < 0x410) cyrillic_lower[i] = cp + 0x50;
+            else if (cp < 0x430) cyrillic_lower[i] = cp + 0x20;
+            else if (cp >= 0x460 && cp % 2 == 0) cyrillic_lower[i] = cp + 1;
+            else cyrillic_lower[i] = cp;
+        }
+    }
+};
+
+inline const Utf8CaseTables& utf8CaseTables() {
+    static const Utf8CaseTables tables;
+    return tables;
+}
+
+// Нижний регистр строки UTF-8 с дописыванием в out.
+// alnumOnly: оставить только буквы и цифры (как cleanWord).
+// ASCII и кириллица обрабатываются по таблицам, остальное - через towlower/iswalnum.
+inline void appendLowerUtf8(std::string& out, std::string_view s, bool alnumOnly) {
+    const Utf8CaseTables& t = utf8CaseTables();
+    size_t pos = 0;
+    while (pos < s.size()) {
+        unsigned char c = s[pos];
+        if (c < 0x80) {
+            if (!alnumOnly || t.ascii_alnum[c]) out += t.ascii_lower[c];
+            ++pos;
+            continue;
+        }
+        if ((c == 0xD0 || c == 0xD1) && pos + 1 < s.size() && ((unsigned char)s[pos + 1] & 0xC0) == 0x80) {
+            int i = ((c & 1) << 6) | ((unsigned char)s[pos + 1] & 0x3F);
+            char16_t lower = t.cyrillic_lower[i];
+            out += (char)(0xC0 | (lower >> 6));
+            out += (char)(0x80 | (lower & 0x3F));
+            pos += 2;
+            continue;
+        }
+        char32_t cp = decodeUtf8(s, pos);
+        if (!alnumOnly || std::iswalnum((wint_t)cp)) appendUtf8(out, (char32_t)std::towlower((wint_t)cp));
+    }
+}
+
+inline std::string toLowerUtf8(std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    appendLowerUtf8(out, s, false);
+    return out;
+}
+
+// Резидентная память процесса в КБ (Linux), -1 если неизвестно
+inline long residentMemoryKb() {
+    FILE* f = std::fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char line[256];
+    long kb = -1;
+    while (std::fgets(line, sizeof(line), f)) {
+        if (std::strncmp(line, "VmRSS:", 6) == 0) {
+            kb = std::strtol(line + 6, nullptr, 10);
+            break;
+        }
+    }
+    std::fclose(f);
+    return kb;
+}
+
+// В консоли Windows ввод и вывод переключаются на UTF-8
+inline void setupUtf8Console() {
+#ifdef _WIN32
+    SetConsoleCP(CP_UTF8);
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+}
@@ -0,0 +1,74 @@
+//Shabarov Vladimir 090304-RPIa-024
+#pragma once
+
+// Общий пул потоков для 2.lab (умножение матриц по плиткам) и 3.lab (уровни BFS).
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков: run() вызывает задачу на каждом потоке (tid 0 - вызывающий)
+// и ждёт завершения всех. Потоки живут всё время работы пула.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable start_cv, done_cv;
+    const std::function<void(int)>* task = nullptr;
+    long long generation = 0;
+    int pending = 0;
+    bool stopping = false;
+
+    void worker_loop(int tid) {
+        long long seen = 0;
+        while (true) {
+            const std::function<void(int)>* current;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                start_cv.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = task;
+            }
+            (*current)(tid);
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (--pending == 0) done_cv.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(int threads) {
+        for (int t = 1; t < std::max(threads, 1); ++t) {
+            workers.emplace_back(&ThreadPool::worker_loop, this, t);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        start_cv.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    int size() const { return (int)workers.size() + 1; }
+
+    void run(const std::function<void(int)>& fn) {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            task = &fn;
+            pending = (int)workers.size();
+            ++generation;
+        }
+        start_cv.notify_all();
+        fn(0);
+        std::unique_lock<std::mutex> lock(m);
+        done_cv.wait(lock, [&] { return pending == 0; });
+    }
+};